@@ -0,0 +1,51 @@
+#ifndef CAPTURE_FORMAT_H
+#define CAPTURE_FORMAT_H
+
+/* ============================================================================
+    $File: $
+    $Date: 2026-10-19
+    $Revision: $
+    $Creator: Pedro Gutierrez
+   ========================================================================= */
+
+// NOTE: Layout of a framebuffer capture file. Everything is u32 in host
+// (little-endian) order, pixels are the 0x00RRGGBB values of the game buffer.
+//
+//   capture_file_header
+//   frame*: capture_frame_header
+//           run* until height rows are covered:
+//               u32 unchanged_rows   (same as the previous frame, nothing stored)
+//               u32 changed_rows
+//               changed_rows * row
+//   row:    token* until width pixels are covered:
+//               u32 count | CAPTURE_TOKEN_REPEAT, u32 delta   (count times delta)
+//               u32 count, count * u32 delta                  (literal deltas)
+//
+// A delta is the pixel minus the same pixel in the previous frame, taken per
+// byte modulo 256 so channels don't borrow from each other. A gradient that
+// scrolls by a pixel, or a fade, then gives the same delta across a row, which
+// a single repeat token covers. The first frame, and any frame whose size
+// differs from the one before it, is taken against a frame of zeros.
+
+#define CAPTURE_FILE_MAGIC  0x50414347 // "GCAP"
+#define CAPTURE_FRAME_MAGIC 0x454D5246 // "FRME"
+#define CAPTURE_VERSION 2
+
+#define CAPTURE_TOKEN_REPEAT 0x80000000
+#define CAPTURE_MAX_DIMENSION 16384
+
+typedef struct
+{
+    u32 magic;
+    u32 version;
+} capture_file_header;
+
+typedef struct
+{
+    u32 magic;
+    u32 frame_index;
+    u32 width;
+    u32 height;
+} capture_frame_header;
+
+#endif
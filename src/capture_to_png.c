@@ -0,0 +1,335 @@
+/* ============================================================================
+    $File: $
+    $Date: 2026-10-19
+    $Revision: $
+    $Creator: Pedro Gutierrez
+   ========================================================================= */
+
+// NOTE: Turns a capture file written by posix_capture.c back into one PNG per
+// frame. The PNGs are uncompressed (stored deflate blocks) so this needs
+// nothing beyond the C library.
+//
+//   capture_to_png <capture_file> <output_prefix>
+//
+// writes <output_prefix>_<frame_index>.png
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#define internal static
+#define global_variable static
+
+typedef uint8_t  u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+
+typedef int8_t  i8;
+typedef int16_t i16;
+typedef int32_t i32;
+typedef int64_t i64;
+
+typedef float  real32;
+typedef double real64;
+
+#include "capture_format.h"
+
+global_variable u32 crc_table[256];
+
+internal void InitializeCrcTable(void)
+{
+    for(u32 n = 0; n < 256; n++)
+    {
+        u32 c = n;
+        for(int k = 0; k < 8; k++)
+        {
+            c = (c & 1) ? (0xEDB88320 ^ (c >> 1)) : (c >> 1);
+        }
+        crc_table[n] = c;
+    }
+}
+
+internal u32 UpdateCrc(u32 crc, u8 *data, size_t size)
+{
+    for(size_t index = 0; index < size; index++)
+    {
+        crc = crc_table[(crc ^ data[index]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+// NOTE: Per byte a + b, modulo 256. Undoes the writer's per byte delta.
+internal u32 CaptureByteAdd(u32 a, u32 b)
+{
+    return ((a & 0x7F7F7F7F) + (b & 0x7F7F7F7F)) ^ ((a ^ b) & 0x80808080);
+}
+
+internal bool WriteBytes(FILE *file, void *data, size_t size)
+{
+    return ((size == 0) || (fwrite(data, 1, size, file) == size));
+}
+
+internal bool WriteBigEndian32(FILE *file, u32 value)
+{
+    u8 bytes[4] = { (u8)(value >> 24), (u8)(value >> 16), (u8)(value >> 8), (u8)value };
+    return WriteBytes(file, bytes, 4);
+}
+
+internal bool WritePngChunk(FILE *file, char *type, u8 *data, u32 size)
+{
+    u32 crc = UpdateCrc(0xFFFFFFFF, (u8*)type, 4);
+    crc = UpdateCrc(crc, data, size);
+
+    return (WriteBigEndian32(file, size) &&
+            WriteBytes(file, type, 4) &&
+            WriteBytes(file, data, size) &&
+            WriteBigEndian32(file, crc ^ 0xFFFFFFFF));
+}
+
+// NOTE: pixels are 0x00RRGGBB, written out as 8-bit RGB. width and height
+// must not be zero, a stored zlib stream needs at least one block.
+internal bool WritePng(char *path, u32 *pixels, u32 width, u32 height)
+{
+    size_t row_size = 1 + (size_t)width * 3;
+    size_t raw_size = row_size * height;
+    size_t block_count = (raw_size + 65534) / 65535;
+    size_t zlib_size = 2 + block_count * 5 + raw_size + 4;
+
+    u8 *raw = (u8*)malloc(raw_size);
+    u8 *zlib = (u8*)malloc(zlib_size);
+    if(!raw || !zlib)
+    {
+        fprintf(stderr, "Error: Out of memory writing %s.\n", path);
+        free(zlib);
+        free(raw);
+        return false;
+    }
+
+    for(u32 y = 0; y < height; y++)
+    {
+        u8 *out = raw + y * row_size;
+        *out++ = 0; // NOTE: Filter type none.
+        for(u32 x = 0; x < width; x++)
+        {
+            u32 pixel = pixels[y * width + x];
+            *out++ = (u8)(pixel >> 16);
+            *out++ = (u8)(pixel >> 8);
+            *out++ = (u8)pixel;
+        }
+    }
+
+    // NOTE: zlib stream made of stored blocks of at most 65535 bytes.
+    u8 *out = zlib;
+    *out++ = 0x78;
+    *out++ = 0x01;
+
+    u32 adler_a = 1;
+    u32 adler_b = 0;
+    for(size_t offset = 0; offset < raw_size; offset += 65535)
+    {
+        size_t size = raw_size - offset;
+        if(size > 65535)
+        {
+            size = 65535;
+        }
+        bool last = ((offset + size) == raw_size);
+        *out++ = last ? 1 : 0;
+        *out++ = (u8)size;
+        *out++ = (u8)(size >> 8);
+        *out++ = (u8)~size;
+        *out++ = (u8)(~size >> 8);
+        memcpy(out, raw + offset, size);
+        out += size;
+
+        for(size_t index = 0; index < size; index++)
+        {
+            adler_a = (adler_a + raw[offset + index]) % 65521;
+            adler_b = (adler_b + adler_a) % 65521;
+        }
+    }
+    u32 adler = (adler_b << 16) | adler_a;
+    *out++ = (u8)(adler >> 24);
+    *out++ = (u8)(adler >> 16);
+    *out++ = (u8)(adler >> 8);
+    *out++ = (u8)adler;
+
+    u8 signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+    u8 ihdr[13] = {0};
+    ihdr[0] = (u8)(width >> 24);  ihdr[1] = (u8)(width >> 16);
+    ihdr[2] = (u8)(width >> 8);   ihdr[3] = (u8)width;
+    ihdr[4] = (u8)(height >> 24); ihdr[5] = (u8)(height >> 16);
+    ihdr[6] = (u8)(height >> 8);  ihdr[7] = (u8)height;
+    ihdr[8] = 8; // NOTE: Bit depth.
+    ihdr[9] = 2; // NOTE: Truecolor RGB.
+
+    bool result = false;
+    FILE *file = fopen(path, "wb");
+    if(file)
+    {
+        result = (WriteBytes(file, signature, sizeof(signature)) &&
+                  WritePngChunk(file, "IHDR", ihdr, sizeof(ihdr)) &&
+                  WritePngChunk(file, "IDAT", zlib, (u32)(out - zlib)) &&
+                  WritePngChunk(file, "IEND", NULL, 0));
+        result = ((fclose(file) == 0) && result);
+    }
+
+    if(!result)
+    {
+        fprintf(stderr, "Error: Could not write %s.\n", path);
+    }
+
+    free(zlib);
+    free(raw);
+    return result;
+}
+
+// NOTE: Applies one encoded row to pixels. False if the file is truncated or
+// the tokens don't add up to exactly width pixels.
+internal bool ReadRow(FILE *file, u32 *pixels, u32 width, u32 *literal)
+{
+    u32 x = 0;
+    while(x < width)
+    {
+        u32 token;
+        if(fread(&token, sizeof(u32), 1, file) != 1)
+        {
+            return false;
+        }
+
+        u32 count = token & ~CAPTURE_TOKEN_REPEAT;
+        if((count == 0) || (count > width - x))
+        {
+            return false;
+        }
+
+        if(token & CAPTURE_TOKEN_REPEAT)
+        {
+            u32 delta;
+            if(fread(&delta, sizeof(u32), 1, file) != 1)
+            {
+                return false;
+            }
+            for(u32 index = 0; index < count; index++, x++)
+            {
+                pixels[x] = CaptureByteAdd(pixels[x], delta);
+            }
+        }
+        else
+        {
+            if(fread(literal, sizeof(u32), count, file) != count)
+            {
+                return false;
+            }
+            for(u32 index = 0; index < count; index++, x++)
+            {
+                pixels[x] = CaptureByteAdd(pixels[x], literal[index]);
+            }
+        }
+    }
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    if(argc < 3)
+    {
+        fprintf(stderr, "Usage: %s <capture_file> <output_prefix>\n", argv[0]);
+        return 1;
+    }
+
+    FILE *file = fopen(argv[1], "rb");
+    if(!file)
+    {
+        fprintf(stderr, "Error: Could not open %s.\n", argv[1]);
+        return 1;
+    }
+
+    capture_file_header file_header;
+    if((fread(&file_header, sizeof(file_header), 1, file) != 1) ||
+       (file_header.magic != CAPTURE_FILE_MAGIC) ||
+       (file_header.version != CAPTURE_VERSION))
+    {
+        fprintf(stderr, "Error: %s is not a version %d capture file.\n", argv[1], CAPTURE_VERSION);
+        return 1;
+    }
+
+    InitializeCrcTable();
+
+    u32 *frame = NULL;
+    u32 *literal = NULL;
+    u32 frame_width = 0;
+    u32 frame_height = 0;
+    u32 frames_written = 0;
+
+    capture_frame_header header;
+    while(fread(&header, sizeof(header), 1, file) == 1)
+    {
+        if((header.magic != CAPTURE_FRAME_MAGIC) ||
+           (header.width == 0) || (header.width > CAPTURE_MAX_DIMENSION) ||
+           (header.height == 0) || (header.height > CAPTURE_MAX_DIMENSION))
+        {
+            fprintf(stderr, "Error: Corrupt frame after %u frames.\n", frames_written);
+            return 1;
+        }
+
+        if((header.width != frame_width) || (header.height != frame_height))
+        {
+            free(frame);
+            free(literal);
+            frame_width = header.width;
+            frame_height = header.height;
+            frame = (u32*)calloc((size_t)frame_width * frame_height, sizeof(u32));
+            literal = (u32*)malloc((size_t)frame_width * sizeof(u32));
+            if(!frame || !literal)
+            {
+                fprintf(stderr, "Error: Out of memory for a %ux%u frame.\n", frame_width, frame_height);
+                return 1;
+            }
+        }
+
+        u32 y = 0;
+        while(y < frame_height)
+        {
+            u32 runs[2];
+            if(fread(runs, sizeof(u32), 2, file) != 2)
+            {
+                fprintf(stderr, "Error: Truncated frame %u.\n", header.frame_index);
+                return 1;
+            }
+            if((runs[0] > frame_height - y) || (runs[1] > frame_height - y - runs[0]) ||
+               ((runs[0] == 0) && (runs[1] == 0)))
+            {
+                fprintf(stderr, "Error: Corrupt frame %u.\n", header.frame_index);
+                return 1;
+            }
+            y += runs[0];
+
+            for(u32 row = 0; row < runs[1]; row++, y++)
+            {
+                if(!ReadRow(file, frame + (size_t)y * frame_width, frame_width, literal))
+                {
+                    fprintf(stderr, "Error: Corrupt or truncated frame %u.\n", header.frame_index);
+                    return 1;
+                }
+            }
+        }
+
+        char path[4096];
+        snprintf(path, sizeof(path), "%s_%06u.png", argv[2], header.frame_index);
+        if(!WritePng(path, frame, frame_width, frame_height))
+        {
+            return 1;
+        }
+        frames_written++;
+    }
+
+    printf("Wrote %u frames.\n", frames_written);
+    free(literal);
+    free(frame);
+    fclose(file);
+    return 0;
+}
@@ -7,6 +7,38 @@
 
 #include "game.h"
 
+internal void InitializeArena(memory_arena *arena, size_t size, void *base)
+{
+    arena->base = (u8*)base;
+    arena->size = size;
+    arena->used = 0;
+}
+
+#define PushStruct(arena, type) (type*)PushSize_(arena, sizeof(type))
+#define PushArray(arena, count, type) (type*)PushSize_(arena, (count)*sizeof(type))
+internal void *PushSize_(memory_arena *arena, size_t size)
+{
+    // NOTE: Keep everything 16 byte aligned so arrays of any type can follow.
+    size = (size + 15) & ~(size_t)15;
+    assert((arena->used + size) <= arena->size);
+    void *result = arena->base + arena->used;
+    arena->used += size;
+    return result;
+}
+
+#include "game_navigation.c"
+#include "game_save.c"
+
+#define WORLD_TILES_X 64
+#define WORLD_TILES_Y 36
+
+// NOTE: Build with -DDEBUG_AGENTS=1 to exercise the navigation service with
+// two walking agents and a door that opens and closes, drawn over the game.
+#if DEBUG_AGENTS
+#define DEBUG_AGENT_STEP_FRAMES 8
+#define DEBUG_DOOR_FRAMES 256
+#endif
+
 internal void RenderWierdGradient(gamescreen_buffer *buffer, int x_offset, int y_offset)
 {
     // NOTE: Big-endian architecture, pixel order is format reversed
@@ -26,14 +58,235 @@ internal void RenderWierdGradient(gamescreen_buffer *buffer, int x_offset, int y
     }
 }
 
-void GameUpdateAndRender(game_input *input, gamescreen_buffer *buffer)
+// NOTE: Stand-in world until there is a real map: a walled border and a few
+// walls with a gap in them so paths have something to go around.
+internal void BuildWorldTiles(u8 *tiles, int width, int height)
+{
+    for(int y = 0; y < height; y++)
+    {
+        for(int x = 0; x < width; x++)
+        {
+            bool border = ((x == 0) || (y == 0) || (x == width - 1) || (y == height - 1));
+            bool wall = (((x % 16) == 8) && ((y % 12) != 6));
+            tiles[y * width + x] = (border || wall);
+        }
+    }
+}
+
+#if DEBUG_AGENTS
+internal void DrawRectangle(gamescreen_buffer *buffer, int min_x, int min_y, int max_x, int max_y, u32 color)
+{
+    min_x = (min_x < 0) ? 0 : min_x;
+    min_y = (min_y < 0) ? 0 : min_y;
+    max_x = (max_x > buffer->width) ? buffer->width : max_x;
+    max_y = (max_y > buffer->height) ? buffer->height : max_y;
+
+    u8 *row = (u8*)buffer->memory + min_y * buffer->pitch;
+    for(int y = min_y; y < max_y; y++)
+    {
+        u32 *pixel = (u32*)row + min_x;
+        for(int x = min_x; x < max_x; x++)
+        {
+            *pixel++ = color;
+        }
+        row += buffer->pitch;
+    }
+}
+
+internal void DrawTile(gamescreen_buffer *buffer, game_state *state, i32 tile_x, i32 tile_y, u32 color)
+{
+    int tile_width = buffer->width / state->world_tiles_x;
+    int tile_height = buffer->height / state->world_tiles_y;
+    DrawRectangle(buffer,
+                  tile_x * tile_width, tile_y * tile_height,
+                  (tile_x + 1) * tile_width, (tile_y + 1) * tile_height,
+                  color);
+}
+
+internal void DebugAgentInitialize(debug_agent *agent, i32 start_x, i32 start_y, i32 goal_x, i32 goal_y)
+{
+    agent->tile.x = start_x;
+    agent->tile.y = start_y;
+    agent->goal.x = goal_x;
+    agent->goal.y = goal_y;
+    agent->other_goal = agent->tile;
+}
+
+internal void DebugAgentSwapGoal(debug_agent *agent)
+{
+    nav_point goal = agent->goal;
+    agent->goal = agent->other_goal;
+    agent->other_goal = goal;
+}
+
+internal void UpdatePathAgent(navigation *nav, debug_agent *agent, bool step)
+{
+    if(!agent->path)
+    {
+        agent->path = NavRequestPath(nav, agent->tile.x, agent->tile.y, agent->goal.x, agent->goal.y);
+        agent->path_step = 0;
+    }
+    else if(agent->path->status == NavRequest_Failed)
+    {
+        // NOTE: Goal walled off, try the other corner.
+        NavReleasePath(agent->path);
+        agent->path = NULL;
+        DebugAgentSwapGoal(agent);
+    }
+    else if((agent->path->status == NavRequest_Done) && step)
+    {
+        nav_path_request *path = agent->path;
+        if((agent->path_step + 1) < path->path_count)
+        {
+            nav_point next = path->path[agent->path_step + 1];
+            if(NavIsWalkable(nav, next.x, next.y))
+            {
+                agent->tile = next;
+                agent->path_step++;
+            }
+            else
+            {
+                // NOTE: A door closed on the path, ask again from here.
+                NavReleasePath(path);
+                agent->path = NULL;
+            }
+        }
+        else
+        {
+            // NOTE: Either at the goal or at the end of a cut short path.
+            NavReleasePath(path);
+            agent->path = NULL;
+            if((agent->tile.x == agent->goal.x) && (agent->tile.y == agent->goal.y))
+            {
+                DebugAgentSwapGoal(agent);
+            }
+        }
+    }
+}
+
+internal void UpdateFlowAgent(navigation *nav, debug_agent *agent, bool step)
+{
+    nav_flow_field *field = NavGetFlowField(nav, agent->goal.x, agent->goal.y);
+    if(field->complete && step)
+    {
+        nav_point direction = NavFlowDirection(nav, field, agent->tile.x, agent->tile.y);
+        agent->tile.x += direction.x;
+        agent->tile.y += direction.y;
+
+        if((agent->tile.x == agent->goal.x) && (agent->tile.y == agent->goal.y))
+        {
+            DebugAgentSwapGoal(agent);
+        }
+    }
+}
+
+#endif
+
+internal game_state *GameInitialize(game_memory *memory)
+{
+    assert(sizeof(game_state) <= memory->permanent_storage_size);
+
+    game_state *state = (game_state*)memory->permanent_storage;
+    if(!memory->is_initialized)
+    {
+        InitializeArena(&state->world_arena,
+                        memory->permanent_storage_size - sizeof(game_state),
+                        (u8*)memory->permanent_storage + sizeof(game_state));
+
+        state->world_tiles_x = WORLD_TILES_X;
+        state->world_tiles_y = WORLD_TILES_Y;
+        state->world_tiles = PushArray(&state->world_arena, WORLD_TILES_X * WORLD_TILES_Y, u8);
+        BuildWorldTiles(state->world_tiles, WORLD_TILES_X, WORLD_TILES_Y);
+
+        NavInitialize(&state->nav, &state->world_arena, WORLD_TILES_X, WORLD_TILES_Y);
+        NavBuildGrid(&state->nav, state->world_tiles);
+
+#if DEBUG_AGENTS
+        DebugAgentInitialize(&state->path_agent, 1, 1, WORLD_TILES_X - 2, WORLD_TILES_Y - 2);
+        DebugAgentInitialize(&state->flow_agent, WORLD_TILES_X - 2, 1, 1, WORLD_TILES_Y - 2);
+#endif
+
+        memory->is_initialized = true;
+    }
+    return state;
+}
+
+size_t GameSaveState(game_memory *memory, void *dest, size_t dest_size)
+{
+    game_state *state = GameInitialize(memory);
+    return SaveWriteSnapshot(state, (u8*)dest, dest_size);
+}
+
+bool GameLoadState(game_memory *memory, void *source, size_t source_size)
+{
+    game_state *state = GameInitialize(memory);
+    bool result = SaveReadSnapshot(state, (u8*)source, source_size);
+    if(result)
+    {
+        NavBuildGrid(&state->nav, state->world_tiles);
+    }
+    return result;
+}
+
+void GameUpdateAndRender(game_memory *memory, game_input *input, gamescreen_buffer *buffer)
 {
-    static int x_offset = 0; 
-    static int y_offset = 0; 
+    game_state *state = GameInitialize(memory);
+
+    game_controller_input *controller = &input->controllers[0];
 
-    game_controller_input *input = 
+    // NOTE: The gradient scrolls on its own, this used to live in the
+    // platform loop where it couldn't be saved.
+    state->x_offset++;
 
     // NOTE: Dealing with buttons and stick input
+    if(controller->up.ended_down)
+    {
+        state->y_offset -= 10;
+    }
+    if(controller->down.ended_down)
+    {
+        state->y_offset += 10;
+    }
+    if(controller->left.ended_down)
+    {
+        state->x_offset -= 10;
+    }
+    if(controller->right.ended_down)
+    {
+        state->x_offset += 10;
+    }
+
+    navigation *nav = &state->nav;
+
+#if DEBUG_AGENTS
+    // NOTE: A door in the first wall opens and closes now and then, so cached
+    // flow fields and paths in flight have to cope with the map changing. It
+    // lives only in the nav grid and follows the frame count, world_tiles and
+    // so the save never see it.
+    bool door_open = (((nav->frame_index / DEBUG_DOOR_FRAMES) & 1) == 0);
+    NavSetWalkable(nav, 8, 1, door_open);
+
+    bool step = ((nav->frame_index % DEBUG_AGENT_STEP_FRAMES) == 0);
+    UpdatePathAgent(nav, &state->path_agent, step);
+    UpdateFlowAgent(nav, &state->flow_agent, step);
+#endif
+
+    NavUpdate(nav, memory);
 
-    RenderWierdGradient(buffer, x_offset, y_offset);
+    RenderWierdGradient(buffer, state->x_offset, state->y_offset);
+
+#if DEBUG_AGENTS
+    for(i32 y = 0; y < state->world_tiles_y; y++)
+    {
+        for(i32 x = 0; x < state->world_tiles_x; x++)
+        {
+            if(!NavIsWalkable(nav, x, y))
+            {
+                DrawTile(buffer, state, x, y, 0x00404040);
+            }
+        }
+    }
+    DrawTile(buffer, state, state->path_agent.tile.x, state->path_agent.tile.y, 0x00FFFF00);
+    DrawTile(buffer, state, state->flow_agent.tile.x, state->flow_agent.tile.y, 0x0000FFFF);
+#endif
 }
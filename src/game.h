@@ -59,6 +59,69 @@ typedef struct
     game_controller_input controllers[2];
 } game_input;
 
-void GameUpdateAndRender(game_input *input, gamescreen_buffer *buffer);
+typedef struct
+{
+    u8 *base;
+    size_t size;
+    size_t used;
+} memory_arena;
+
+// NOTE: Services the platform gives to the game. The clock is used to keep
+// time-sliced work (pathfinding) within a per-frame budget.
+typedef u64 platform_get_wall_clock(void);
+
+typedef struct
+{
+    bool is_initialized;
+
+    size_t permanent_storage_size;
+    void *permanent_storage; // NOTE: Must be cleared to zero at startup.
+
+    platform_get_wall_clock *GetWallClock;
+    u64 wall_clock_frequency;
+} game_memory;
+
+#include "game_navigation.h"
+#include "game_save.h"
+
+#if DEBUG_AGENTS
+// NOTE: Walks between two corners of the world so the navigation service is
+// exercised every frame. One agent follows A* paths, the other a flow field.
+typedef struct
+{
+    nav_point tile;
+    nav_point goal;
+    nav_point other_goal;
+
+    nav_path_request *path;
+    u32 path_step;
+} debug_agent;
+#endif
+
+typedef struct
+{
+    memory_arena world_arena;
+
+    int x_offset;
+    int y_offset;
+
+    i32 world_tiles_x;
+    i32 world_tiles_y;
+    u8 *world_tiles;
+
+    navigation nav;
+#if DEBUG_AGENTS
+    debug_agent path_agent;
+    debug_agent flow_agent;
+#endif
+} game_state;
+
+void GameUpdateAndRender(game_memory *memory, game_input *input, gamescreen_buffer *buffer);
+
+// NOTE: Snapshot of the game state in the format described in game_save.h.
+// Save returns the number of bytes written to dest, zero if it doesn't fit.
+// Load leaves the state untouched if the snapshot is bad.
+size_t GameSaveState(game_memory *memory, void *dest, size_t dest_size);
+bool GameLoadState(game_memory *memory, void *source, size_t source_size);
 
 #endif
@@ -0,0 +1,519 @@
+/* ============================================================================
+    $File: $
+    $Date: 2026-10-19
+    $Revision: $
+    $Creator: Pedro Gutierrez
+   ========================================================================= */
+
+#define NAV_NO_NODE      0xFFFFFFFF
+#define NAV_NOT_IN_HEAP  0xFFFFFFFF
+#define NAV_CLOSED       0xFFFFFFFE
+#define NAV_UNREACHABLE  0xFFFFFFFF
+
+// NOTE: How much work is done between two reads of the wall clock.
+#define NAV_SEARCH_STEPS_PER_CHECK 64
+#define NAV_FLOW_STEPS_PER_CHECK 256
+
+global_variable i32 nav_neighbour_dx[4] = { 1, -1,  0,  0 };
+global_variable i32 nav_neighbour_dy[4] = { 0,  0,  1, -1 };
+
+void NavInitialize(navigation *nav, memory_arena *arena, i32 width, i32 height)
+{
+    u32 tile_count = (u32)(width * height);
+
+    nav->width = width;
+    nav->height = height;
+    nav->budget_us = NAV_DEFAULT_BUDGET_US;
+    nav->map_version = 1;
+
+    nav->walkable    = PushArray(arena, tile_count, u8);
+    nav->heap        = PushArray(arena, tile_count, u32);
+    nav->heap_index  = PushArray(arena, tile_count, u32);
+    nav->g_cost      = PushArray(arena, tile_count, u32);
+    nav->f_cost      = PushArray(arena, tile_count, u32);
+    nav->parent      = PushArray(arena, tile_count, u32);
+    nav->visit_stamp = PushArray(arena, tile_count, u32);
+
+    for(int index = 0; index < NAV_MAX_FLOW_FIELDS; index++)
+    {
+        nav_flow_field *field = &nav->flow_fields[index];
+        field->distance = PushArray(arena, tile_count, u32);
+        field->frontier = PushArray(arena, tile_count, u32);
+    }
+}
+
+bool NavIsWalkable(navigation *nav, i32 x, i32 y)
+{
+    bool result = false;
+    if((x >= 0) && (y >= 0) && (x < nav->width) && (y < nav->height))
+    {
+        result = (nav->walkable[y * nav->width + x] != 0);
+    }
+    return result;
+}
+
+// NOTE: tiles holds one byte per tile, zero means open ground.
+void NavBuildGrid(navigation *nav, u8 *tiles)
+{
+    u32 tile_count = (u32)(nav->width * nav->height);
+    for(u32 index = 0; index < tile_count; index++)
+    {
+        nav->walkable[index] = (tiles[index] == 0);
+    }
+    nav->map_version++;
+}
+
+void NavSetWalkable(navigation *nav, i32 x, i32 y, bool walkable)
+{
+    if((x >= 0) && (y >= 0) && (x < nav->width) && (y < nav->height))
+    {
+        u8 *tile = &nav->walkable[y * nav->width + x];
+        if(*tile != walkable)
+        {
+            *tile = walkable;
+            nav->map_version++;
+        }
+    }
+}
+
+//
+// NOTE: A* path requests
+//
+
+nav_path_request *NavRequestPath(navigation *nav, i32 start_x, i32 start_y, i32 goal_x, i32 goal_y)
+{
+    nav_path_request *result = NULL;
+    if(nav->queue_count < NAV_MAX_PATH_REQUESTS)
+    {
+        for(int index = 0; index < NAV_MAX_PATH_REQUESTS; index++)
+        {
+            nav_path_request *request = &nav->requests[index];
+            if(request->status == NavRequest_Free)
+            {
+                request->status = NavRequest_Queued;
+                request->start.x = start_x;
+                request->start.y = start_y;
+                request->goal.x = goal_x;
+                request->goal.y = goal_y;
+                request->path_count = 0;
+
+                u32 slot = (nav->queue_read + nav->queue_count) % NAV_MAX_PATH_REQUESTS;
+                nav->queue[slot] = request;
+                nav->queue_count++;
+
+                result = request;
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+// NOTE: Only call this once the request is Done or Failed.
+void NavReleasePath(nav_path_request *request)
+{
+    assert((request->status == NavRequest_Done) || (request->status == NavRequest_Failed));
+    request->status = NavRequest_Free;
+}
+
+internal u32 NavHeuristic(navigation *nav, u32 node, nav_point goal)
+{
+    i32 dx = (i32)(node % (u32)nav->width) - goal.x;
+    i32 dy = (i32)(node / (u32)nav->width) - goal.y;
+    return (u32)(((dx < 0) ? -dx : dx) + ((dy < 0) ? -dy : dy));
+}
+
+// NOTE: Ties on f go to the node with the larger g, it is closer to the goal.
+internal bool NavHeapLess(navigation *nav, u32 a, u32 b)
+{
+    bool result = ((nav->f_cost[a] < nav->f_cost[b]) ||
+                   ((nav->f_cost[a] == nav->f_cost[b]) && (nav->g_cost[a] > nav->g_cost[b])));
+    return result;
+}
+
+internal void NavHeapSiftUp(navigation *nav, u32 position)
+{
+    u32 node = nav->heap[position];
+    while(position > 0)
+    {
+        u32 parent_position = (position - 1) / 2;
+        u32 parent_node = nav->heap[parent_position];
+        if(!NavHeapLess(nav, node, parent_node))
+        {
+            break;
+        }
+        nav->heap[position] = parent_node;
+        nav->heap_index[parent_node] = position;
+        position = parent_position;
+    }
+    nav->heap[position] = node;
+    nav->heap_index[node] = position;
+}
+
+internal void NavHeapPush(navigation *nav, u32 node)
+{
+    nav->heap[nav->heap_count] = node;
+    NavHeapSiftUp(nav, nav->heap_count++);
+}
+
+internal u32 NavHeapPop(navigation *nav)
+{
+    u32 result = nav->heap[0];
+    u32 last = nav->heap[--nav->heap_count];
+
+    u32 position = 0;
+    for(;;)
+    {
+        u32 child = 2 * position + 1;
+        if(child >= nav->heap_count)
+        {
+            break;
+        }
+        if(((child + 1) < nav->heap_count) && NavHeapLess(nav, nav->heap[child + 1], nav->heap[child]))
+        {
+            child++;
+        }
+        if(!NavHeapLess(nav, nav->heap[child], last))
+        {
+            break;
+        }
+        nav->heap[position] = nav->heap[child];
+        nav->heap_index[nav->heap[position]] = position;
+        position = child;
+    }
+    if(nav->heap_count > 0)
+    {
+        nav->heap[position] = last;
+        nav->heap_index[last] = position;
+    }
+
+    nav->heap_index[result] = NAV_CLOSED;
+    return result;
+}
+
+internal void NavTouchNode(navigation *nav, u32 node)
+{
+    if(nav->visit_stamp[node] != nav->search_stamp)
+    {
+        nav->visit_stamp[node] = nav->search_stamp;
+        nav->g_cost[node] = NAV_UNREACHABLE;
+        nav->heap_index[node] = NAV_NOT_IN_HEAP;
+        nav->parent[node] = NAV_NO_NODE;
+    }
+}
+
+internal void NavBeginSearch(navigation *nav, nav_path_request *request)
+{
+    nav->active_request = request;
+    nav->search_map_version = nav->map_version;
+    nav->heap_count = 0;
+
+    // NOTE: On wrap-around old stamps could match again, so clear them once.
+    if(++nav->search_stamp == 0)
+    {
+        u32 tile_count = (u32)(nav->width * nav->height);
+        for(u32 index = 0; index < tile_count; index++)
+        {
+            nav->visit_stamp[index] = 0;
+        }
+        nav->search_stamp = 1;
+    }
+
+    if(NavIsWalkable(nav, request->start.x, request->start.y) &&
+       NavIsWalkable(nav, request->goal.x, request->goal.y))
+    {
+        request->status = NavRequest_Searching;
+
+        u32 start = (u32)(request->start.y * nav->width + request->start.x);
+        NavTouchNode(nav, start);
+        nav->g_cost[start] = 0;
+        nav->f_cost[start] = NavHeuristic(nav, start, request->goal);
+        NavHeapPush(nav, start);
+    }
+    else
+    {
+        request->status = NavRequest_Failed;
+        nav->active_request = NULL;
+    }
+}
+
+internal void NavFinishSearch(navigation *nav, u32 goal)
+{
+    nav_path_request *request = nav->active_request;
+
+    u32 length = 0;
+    for(u32 node = goal; node != NAV_NO_NODE; node = nav->parent[node])
+    {
+        length++;
+    }
+
+    // NOTE: Walk back from the goal, dropping the tail that does not fit.
+    u32 count = (length < NAV_MAX_PATH_LENGTH) ? length : NAV_MAX_PATH_LENGTH;
+    u32 position = length;
+    for(u32 node = goal; node != NAV_NO_NODE; node = nav->parent[node])
+    {
+        position--;
+        if(position < count)
+        {
+            request->path[position].x = (i32)(node % (u32)nav->width);
+            request->path[position].y = (i32)(node / (u32)nav->width);
+        }
+    }
+
+    request->path_count = count;
+    request->status = NavRequest_Done;
+    nav->active_request = NULL;
+}
+
+internal void NavStepSearch(navigation *nav, u32 step_count)
+{
+    nav_path_request *request = nav->active_request;
+    u32 goal = (u32)(request->goal.y * nav->width + request->goal.x);
+
+    for(u32 step = 0; step < step_count; step++)
+    {
+        if(nav->heap_count == 0)
+        {
+            request->status = NavRequest_Failed;
+            nav->active_request = NULL;
+            break;
+        }
+
+        u32 node = NavHeapPop(nav);
+        if(node == goal)
+        {
+            NavFinishSearch(nav, goal);
+            break;
+        }
+
+        i32 x = (i32)(node % (u32)nav->width);
+        i32 y = (i32)(node / (u32)nav->width);
+        for(int direction = 0; direction < 4; direction++)
+        {
+            i32 next_x = x + nav_neighbour_dx[direction];
+            i32 next_y = y + nav_neighbour_dy[direction];
+            if(!NavIsWalkable(nav, next_x, next_y))
+            {
+                continue;
+            }
+
+            u32 next = (u32)(next_y * nav->width + next_x);
+            NavTouchNode(nav, next);
+            if(nav->heap_index[next] == NAV_CLOSED)
+            {
+                continue;
+            }
+
+            u32 g = nav->g_cost[node] + 1;
+            if(g < nav->g_cost[next])
+            {
+                nav->g_cost[next] = g;
+                nav->f_cost[next] = g + NavHeuristic(nav, next, request->goal);
+                nav->parent[next] = node;
+                if(nav->heap_index[next] == NAV_NOT_IN_HEAP)
+                {
+                    NavHeapPush(nav, next);
+                }
+                else
+                {
+                    NavHeapSiftUp(nav, nav->heap_index[next]);
+                }
+            }
+        }
+    }
+}
+
+//
+// NOTE: Flow fields, shared by every agent heading to the same goal
+//
+
+internal void NavBeginFlowField(navigation *nav, nav_flow_field *field)
+{
+    u32 tile_count = (u32)(nav->width * nav->height);
+    for(u32 index = 0; index < tile_count; index++)
+    {
+        field->distance[index] = NAV_UNREACHABLE;
+    }
+
+    field->map_version = nav->map_version;
+    field->frontier_read = 0;
+    field->frontier_write = 0;
+    field->complete = false;
+
+    if(NavIsWalkable(nav, field->goal.x, field->goal.y))
+    {
+        u32 goal = (u32)(field->goal.y * nav->width + field->goal.x);
+        field->distance[goal] = 0;
+        field->frontier[field->frontier_write++] = goal;
+    }
+    else
+    {
+        field->complete = true;
+    }
+}
+
+// NOTE: Returns the cached field for this goal, starting a new one if needed
+// (evicting the least recently used). The field may still be filling in,
+// check complete before steering with it. Ask again every frame: a field
+// built against an old map is restarted here.
+nav_flow_field *NavGetFlowField(navigation *nav, i32 goal_x, i32 goal_y)
+{
+    nav_flow_field *result = NULL;
+    nav_flow_field *oldest = NULL;
+
+    for(int index = 0; index < NAV_MAX_FLOW_FIELDS; index++)
+    {
+        nav_flow_field *field = &nav->flow_fields[index];
+        if(field->in_use && (field->goal.x == goal_x) && (field->goal.y == goal_y))
+        {
+            result = field;
+            break;
+        }
+
+        if(!oldest || (oldest->in_use && (!field->in_use || (field->last_used_frame < oldest->last_used_frame))))
+        {
+            oldest = field;
+        }
+    }
+
+    if(!result)
+    {
+        result = oldest;
+        result->in_use = true;
+        result->goal.x = goal_x;
+        result->goal.y = goal_y;
+        NavBeginFlowField(nav, result);
+    }
+    else if(result->map_version != nav->map_version)
+    {
+        NavBeginFlowField(nav, result);
+    }
+
+    result->last_used_frame = nav->frame_index;
+    return result;
+}
+
+internal void NavStepFlowField(navigation *nav, nav_flow_field *field, u32 step_count)
+{
+    for(u32 step = 0; step < step_count; step++)
+    {
+        if(field->frontier_read == field->frontier_write)
+        {
+            field->complete = true;
+            break;
+        }
+
+        u32 node = field->frontier[field->frontier_read++];
+        i32 x = (i32)(node % (u32)nav->width);
+        i32 y = (i32)(node / (u32)nav->width);
+        for(int direction = 0; direction < 4; direction++)
+        {
+            i32 next_x = x + nav_neighbour_dx[direction];
+            i32 next_y = y + nav_neighbour_dy[direction];
+            if(NavIsWalkable(nav, next_x, next_y))
+            {
+                u32 next = (u32)(next_y * nav->width + next_x);
+                if(field->distance[next] == NAV_UNREACHABLE)
+                {
+                    field->distance[next] = field->distance[node] + 1;
+                    field->frontier[field->frontier_write++] = next;
+                }
+            }
+        }
+    }
+}
+
+// NOTE: Step to take from (x, y) to get closer to the field's goal. Zero when
+// already there, when the goal can't be reached or the field isn't ready.
+nav_point NavFlowDirection(navigation *nav, nav_flow_field *field, i32 x, i32 y)
+{
+    nav_point result = {0};
+    if(field->complete && (field->map_version == nav->map_version) && NavIsWalkable(nav, x, y))
+    {
+        u32 best = field->distance[y * nav->width + x];
+        for(int direction = 0; direction < 4; direction++)
+        {
+            i32 next_x = x + nav_neighbour_dx[direction];
+            i32 next_y = y + nav_neighbour_dy[direction];
+            if(NavIsWalkable(nav, next_x, next_y))
+            {
+                u32 distance = field->distance[next_y * nav->width + next_x];
+                if(distance < best)
+                {
+                    best = distance;
+                    result.x = nav_neighbour_dx[direction];
+                    result.y = nav_neighbour_dy[direction];
+                }
+            }
+        }
+    }
+    return result;
+}
+
+//
+// NOTE: Per-frame driver
+//
+
+internal bool NavHasWork(navigation *nav)
+{
+    bool result = (nav->active_request || (nav->queue_count > 0));
+    for(int index = 0; !result && (index < NAV_MAX_FLOW_FIELDS); index++)
+    {
+        nav_flow_field *field = &nav->flow_fields[index];
+        result = (field->in_use && !field->complete);
+    }
+    return result;
+}
+
+// NOTE: Works through queued path requests first, then unfinished flow
+// fields, until the budget for this frame runs out.
+void NavUpdate(navigation *nav, game_memory *memory)
+{
+    nav->frame_index++;
+
+    u64 start_counter = memory->GetWallClock();
+    u64 budget_counter = ((u64)nav->budget_us * memory->wall_clock_frequency) / 1000000;
+
+    while(NavHasWork(nav))
+    {
+        if(nav->active_request && (nav->search_map_version != nav->map_version))
+        {
+            // NOTE: The map changed under the search, start it over.
+            NavBeginSearch(nav, nav->active_request);
+        }
+
+        if(!nav->active_request && (nav->queue_count > 0))
+        {
+            nav_path_request *request = nav->queue[nav->queue_read];
+            nav->queue_read = (nav->queue_read + 1) % NAV_MAX_PATH_REQUESTS;
+            nav->queue_count--;
+            NavBeginSearch(nav, request);
+        }
+
+        if(nav->active_request)
+        {
+            NavStepSearch(nav, NAV_SEARCH_STEPS_PER_CHECK);
+        }
+        else
+        {
+            for(int index = 0; index < NAV_MAX_FLOW_FIELDS; index++)
+            {
+                nav_flow_field *field = &nav->flow_fields[index];
+                if(field->in_use && !field->complete)
+                {
+                    if(field->map_version != nav->map_version)
+                    {
+                        NavBeginFlowField(nav, field);
+                    }
+                    NavStepFlowField(nav, field, NAV_FLOW_STEPS_PER_CHECK);
+                    break;
+                }
+            }
+        }
+
+        if((memory->GetWallClock() - start_counter) >= budget_counter)
+        {
+            break;
+        }
+    }
+}
@@ -0,0 +1,113 @@
+#ifndef GAME_NAVIGATION_H
+#define GAME_NAVIGATION_H
+
+/* ============================================================================
+    $File: $
+    $Date: 2026-10-19
+    $Revision: $
+    $Creator: Pedro Gutierrez
+   ========================================================================= */
+
+// NOTE: Pathfinding over the world tile grid. All memory is pushed from the
+// world arena at startup, nothing is allocated while the game runs. Path
+// requests are queued and NavUpdate works on them for at most budget_us
+// microseconds per frame, so a burst of requests never spikes a single frame.
+
+#define NAV_MAX_PATH_REQUESTS 64
+#define NAV_MAX_PATH_LENGTH 256
+#define NAV_MAX_FLOW_FIELDS 8
+#define NAV_DEFAULT_BUDGET_US 500
+
+typedef struct
+{
+    i32 x;
+    i32 y;
+} nav_point;
+
+typedef enum
+{
+    NavRequest_Free,
+    NavRequest_Queued,
+    NavRequest_Searching,
+    NavRequest_Done,
+    NavRequest_Failed,
+} nav_request_status;
+
+typedef struct
+{
+    nav_request_status status;
+
+    nav_point start;
+    nav_point goal;
+
+    // NOTE: Tiles from start to goal, both included. Paths longer than
+    // NAV_MAX_PATH_LENGTH are cut short, the agent asks again from there.
+    u32 path_count;
+    nav_point path[NAV_MAX_PATH_LENGTH];
+} nav_path_request;
+
+typedef struct
+{
+    bool in_use;
+    bool complete;
+
+    nav_point goal;
+    u32 map_version;
+    u64 last_used_frame;
+
+    // NOTE: Steps to the goal for every tile, filled breadth first. The
+    // frontier is kept between frames so the fill can be time-sliced.
+    u32 *distance;
+    u32 *frontier;
+    u32 frontier_read;
+    u32 frontier_write;
+} nav_flow_field;
+
+typedef struct
+{
+    i32 width;
+    i32 height;
+    u8 *walkable;
+
+    // NOTE: Bumped every time the walkability changes. Cached flow fields and
+    // in-flight searches built against an older version are thrown away.
+    u32 map_version;
+    u64 frame_index;
+    u32 budget_us;
+
+    // NOTE: A* scratch, one entry per tile. Entries are only valid when their
+    // visit_stamp matches search_stamp so nothing is cleared between searches.
+    u32 *heap;
+    u32 heap_count;
+    u32 *heap_index;
+    u32 *g_cost;
+    u32 *f_cost;
+    u32 *parent;
+    u32 *visit_stamp;
+    u32 search_stamp;
+    u32 search_map_version;
+    nav_path_request *active_request;
+
+    nav_path_request requests[NAV_MAX_PATH_REQUESTS];
+    nav_path_request *queue[NAV_MAX_PATH_REQUESTS];
+    u32 queue_read;
+    u32 queue_count;
+
+    nav_flow_field flow_fields[NAV_MAX_FLOW_FIELDS];
+} navigation;
+
+// NOTE: The service the rest of the game uses, see game_navigation.c.
+void NavInitialize(navigation *nav, memory_arena *arena, i32 width, i32 height);
+void NavBuildGrid(navigation *nav, u8 *tiles);
+void NavSetWalkable(navigation *nav, i32 x, i32 y, bool walkable);
+bool NavIsWalkable(navigation *nav, i32 x, i32 y);
+
+nav_path_request *NavRequestPath(navigation *nav, i32 start_x, i32 start_y, i32 goal_x, i32 goal_y);
+void NavReleasePath(nav_path_request *request);
+
+nav_flow_field *NavGetFlowField(navigation *nav, i32 goal_x, i32 goal_y);
+nav_point NavFlowDirection(navigation *nav, nav_flow_field *field, i32 x, i32 y);
+
+void NavUpdate(navigation *nav, game_memory *memory);
+
+#endif
@@ -0,0 +1,130 @@
+/* ============================================================================
+    $File: $
+    $Date: 2026-10-19
+    $Revision: $
+    $Creator: Pedro Gutierrez
+   ========================================================================= */
+
+typedef struct
+{
+    u8 *at;
+    size_t remaining;
+    bool overflow;
+} save_stream;
+
+internal void SaveBytes(save_stream *stream, void *data, size_t size)
+{
+    if(stream->overflow || (size > stream->remaining))
+    {
+        stream->overflow = true;
+        return;
+    }
+    memcpy(stream->at, data, size);
+    stream->at += size;
+    stream->remaining -= size;
+}
+
+internal void LoadBytes(save_stream *stream, void *data, size_t size)
+{
+    if(stream->overflow || (size > stream->remaining))
+    {
+        stream->overflow = true;
+        return;
+    }
+    memcpy(data, stream->at, size);
+    stream->at += size;
+    stream->remaining -= size;
+}
+
+internal u32 SaveChecksum(u8 *data, size_t size)
+{
+    u32 hash = 2166136261u;
+    for(size_t index = 0; index < size; index++)
+    {
+        hash = (hash ^ data[index]) * 16777619u;
+    }
+    return hash;
+}
+
+internal size_t SaveWriteSnapshot(game_state *state, u8 *dest, size_t dest_size)
+{
+    if(dest_size < sizeof(save_header))
+    {
+        return 0;
+    }
+
+    save_stream stream = {0};
+    stream.at = dest + sizeof(save_header);
+    stream.remaining = dest_size - sizeof(save_header);
+
+    SaveBytes(&stream, &state->x_offset, sizeof(i32));
+    SaveBytes(&stream, &state->y_offset, sizeof(i32));
+    SaveBytes(&stream, &state->world_tiles_x, sizeof(i32));
+    SaveBytes(&stream, &state->world_tiles_y, sizeof(i32));
+    SaveBytes(&stream, state->world_tiles, (size_t)state->world_tiles_x * state->world_tiles_y);
+
+    if(stream.overflow)
+    {
+        return 0;
+    }
+
+    save_header header = {0};
+    header.magic = SAVE_MAGIC;
+    header.version = SAVE_VERSION;
+    header.payload_size = (u32)(stream.at - (dest + sizeof(save_header)));
+    header.checksum = SaveChecksum(dest + sizeof(save_header), header.payload_size);
+    memcpy(dest, &header, sizeof(header));
+
+    return sizeof(save_header) + header.payload_size;
+}
+
+// NOTE: Everything is checked before the state is written to, a bad snapshot
+// leaves the game as it was.
+internal bool SaveReadSnapshot(game_state *state, u8 *source, size_t source_size)
+{
+    save_header header;
+    if(source_size < sizeof(header))
+    {
+        return false;
+    }
+    memcpy(&header, source, sizeof(header));
+
+    if((header.magic != SAVE_MAGIC) ||
+       (header.version == 0) || (header.version > SAVE_VERSION) ||
+       (header.payload_size > source_size - sizeof(header)))
+    {
+        return false;
+    }
+
+    u8 *payload = source + sizeof(header);
+    if(SaveChecksum(payload, header.payload_size) != header.checksum)
+    {
+        return false;
+    }
+
+    save_stream stream = {0};
+    stream.at = payload;
+    stream.remaining = header.payload_size;
+
+    i32 x_offset, y_offset, tiles_x, tiles_y;
+    LoadBytes(&stream, &x_offset, sizeof(i32));
+    LoadBytes(&stream, &y_offset, sizeof(i32));
+    LoadBytes(&stream, &tiles_x, sizeof(i32));
+    LoadBytes(&stream, &tiles_y, sizeof(i32));
+
+    // NOTE: The world size is fixed for now, a snapshot of another size can't
+    // be loaded into the tiles we already pushed.
+    size_t tile_count = (size_t)state->world_tiles_x * state->world_tiles_y;
+    if(stream.overflow ||
+       (tiles_x != state->world_tiles_x) || (tiles_y != state->world_tiles_y) ||
+       (stream.remaining < tile_count))
+    {
+        return false;
+    }
+
+    state->x_offset = x_offset;
+    state->y_offset = y_offset;
+    LoadBytes(&stream, state->world_tiles, tile_count);
+
+    return true;
+}
@@ -0,0 +1,36 @@
+#ifndef GAME_SAVE_H
+#define GAME_SAVE_H
+
+/* ============================================================================
+    $File: $
+    $Date: 2026-10-19
+    $Revision: $
+    $Creator: Pedro Gutierrez
+   ========================================================================= */
+
+// NOTE: Layout of a game state snapshot. Everything is in host
+// (little-endian) order.
+//
+//   save_header
+//   payload, payload_size bytes, checksum is FNV-1a over it:
+//       version 1:
+//           i32 x_offset
+//           i32 y_offset
+//           i32 world_tiles_x
+//           i32 world_tiles_y
+//           u8  world_tiles[world_tiles_x * world_tiles_y]
+//
+// Bump SAVE_VERSION when the payload changes and keep reading the old ones.
+
+#define SAVE_MAGIC 0x56415347 // "GSAV"
+#define SAVE_VERSION 1
+
+typedef struct
+{
+    u32 magic;
+    u32 version;
+    u32 payload_size;
+    u32 checksum;
+} save_header;
+
+#endif
@@ -0,0 +1,145 @@
+/* ============================================================================
+    $File: $
+    $Date: 2026-10-19
+    $Revision: $
+    $Creator: Pedro Gutierrez
+   ========================================================================= */
+
+// NOTE: Platform layer with no window. Runs the game for a fixed number of
+// frames into a memory buffer, optionally capturing them to disk. Used to diff
+// rendering output across changes on machines without a display.
+//
+//   game_headless [frames] [capture_file|-] [capture_every_n_frames] [save_file]
+//
+// With a save file the state is loaded from it at startup, autosaved every
+// HEADLESS_AUTOSAVE_FRAMES frames and saved again on exit.
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <string.h>
+#include <time.h>
+
+#define internal static
+#define global_variable static
+
+typedef uint8_t  u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+
+typedef int8_t  i8;
+typedef int16_t i16;
+typedef int32_t i32;
+typedef int64_t i64;
+
+typedef float  real32;
+typedef double real64;
+
+#include "game.c"
+#include "posix_capture.c"
+#include "posix_save.c"
+
+#define HEADLESS_WIDTH 1280
+#define HEADLESS_HEIGHT 720
+#define HEADLESS_AUTOSAVE_FRAMES 60
+
+internal u64 LinuxGetWallClock(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (u64)now.tv_sec * 1000000000ull + (u64)now.tv_nsec;
+}
+
+int main(int argc, char *argv[])
+{
+    int frame_count = (argc > 1) ? atoi(argv[1]) : 60;
+    char *capture_path = ((argc > 2) && (strcmp(argv[2], "-") != 0)) ? argv[2] : NULL;
+    int capture_every_n = (argc > 3) ? atoi(argv[3]) : 1;
+    char *save_path = (argc > 4) ? argv[4] : NULL;
+
+    gamescreen_buffer buffer = {0};
+    buffer.width = HEADLESS_WIDTH;
+    buffer.height = HEADLESS_HEIGHT;
+    buffer.bytes_per_pixel = 4;
+    buffer.pitch = buffer.width * buffer.bytes_per_pixel;
+    buffer.memory = malloc(buffer.pitch * buffer.height);
+
+    game_memory memory = {0};
+    memory.permanent_storage_size = 64 * 1024 * 1024;
+    memory.permanent_storage = calloc(1, memory.permanent_storage_size);
+    memory.GetWallClock = LinuxGetWallClock;
+    memory.wall_clock_frequency = 1000000000ull;
+
+    if(!buffer.memory || !memory.permanent_storage)
+    {
+        fprintf(stderr, "Error: Could not allocate game memory.\n");
+        return 1;
+    }
+
+    frame_capture capture;
+    bool capturing = false;
+    if(capture_path)
+    {
+        // NOTE: No frame deadline here, so wait on the writer rather than drop
+        // frames and make two captures of the same run differ.
+        capturing = CaptureBegin(&capture, capture_path, capture_every_n,
+                                 buffer.width, buffer.height, true);
+        if(!capturing)
+        {
+            return 1;
+        }
+    }
+
+    save_writer saver;
+    bool saving = false;
+    if(save_path)
+    {
+        LoadGameFile(save_path, &memory);
+        saving = SaveWriterBegin(&saver, save_path, SAVE_STAGING_SIZE);
+    }
+    u64 slowest_save = 0;
+
+    u64 start_counter = LinuxGetWallClock();
+
+    for(int frame = 0; frame < frame_count; frame++)
+    {
+        game_input input = {0};
+        GameUpdateAndRender(&memory, &input, &buffer);
+
+        if(capturing)
+        {
+            CaptureFrame(&capture, &buffer);
+        }
+
+        if(saving && ((frame % HEADLESS_AUTOSAVE_FRAMES) == HEADLESS_AUTOSAVE_FRAMES - 1))
+        {
+            u64 save_start = LinuxGetWallClock();
+            SaveWriterSubmit(&saver, &memory);
+            u64 save_elapsed = LinuxGetWallClock() - save_start;
+            slowest_save = (save_elapsed > slowest_save) ? save_elapsed : slowest_save;
+        }
+    }
+
+    real64 elapsed_ms = (real64)(LinuxGetWallClock() - start_counter) / 1000000.0;
+    printf("%d frames, %f ms/f\n", frame_count, elapsed_ms / (real64)frame_count);
+
+    int result = 0;
+    if(capturing && !CaptureEnd(&capture))
+    {
+        result = 1;
+    }
+
+    if(saving)
+    {
+        printf("slowest autosave %f ms on the game loop\n", (real64)slowest_save / 1000000.0);
+        SaveWriterFlush(&saver, &memory);
+        SaveWriterEnd(&saver);
+    }
+
+    return result;
+}
@@ -8,6 +8,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <assert.h>
 #include <SDL2/SDL.h>
 #include <mach/mach_time.h>
 
@@ -28,6 +29,11 @@ typedef float  real32;
 typedef double real64;
 
 #include "game.c"
+#include "posix_capture.c"
+#include "posix_save.c"
+
+#define SAVE_PATH "game.sav"
+#define AUTOSAVE_SECONDS 30
 
 typedef struct {
     SDL_Texture *color_texture;
@@ -167,7 +173,7 @@ internal void MacOsRenderToScreen(SDL_Renderer *renderer, window_buffer *buffer)
     SDL_RenderPresent(renderer);
 }
 
-interal void MacOsProcessGamepadInput(game_button_state *old_state, 
+internal void MacOsProcessGamepadInput(game_button_state *old_state, 
                                       game_button_state *new_state, 
                                       SDL_GameController *controller, 
                                       SDL_GameControllerButton button)
@@ -201,8 +207,32 @@ int main(int argc, char *argv[])
             window_dimensions dimensions = MacOsGetWindowSize(window);
             MacOsSetupScreen(renderer, &global_window_buffer, dimensions.width, dimensions.height);
 
-            int x_offset = 0;
-            int y_offset = 0;
+            game_memory memory = {0};
+            memory.permanent_storage_size = 64 * 1024 * 1024;
+            memory.permanent_storage = calloc(1, memory.permanent_storage_size);
+            if(!memory.permanent_storage)
+            {
+                fprintf(stderr, "Error: Could not allocate game memory.\n");
+                return 1;
+            }
+            memory.GetWallClock = SDL_GetPerformanceCounter;
+            memory.wall_clock_frequency = counter_frequency;
+
+            LoadGameFile(SAVE_PATH, &memory);
+
+            save_writer saver;
+            bool saving = SaveWriterBegin(&saver, SAVE_PATH, SAVE_STAGING_SIZE);
+            u64 last_save_counter = SDL_GetPerformanceCounter();
+
+            // NOTE: game -capture <file> [every_n_frames] dumps frames to disk.
+            frame_capture capture;
+            bool capturing = false;
+            if((argc > 2) && (strcmp(argv[1], "-capture") == 0))
+            {
+                int every_n_frames = (argc > 3) ? atoi(argv[3]) : 1;
+                capturing = CaptureBegin(&capture, argv[2], every_n_frames,
+                                         global_window_buffer.width, global_window_buffer.height, false);
+            }
 
             // Game loop
             running = true;
@@ -247,10 +277,11 @@ int main(int argc, char *argv[])
                         u16 stick_x = SDL_GameControllerGetAxis(controller, SDL_CONTROLLER_AXIS_LEFTX);
                         u16 stick_y = SDL_GameControllerGetAxis(controller, SDL_CONTROLLER_AXIS_LEFTY);
 
-                        if(x_button)
-                        {
-                            y_offset += 10; 
-                       }
+                        game_controller_input *controller_input = &input.controllers[0];
+                        controller_input->up.ended_down = up;
+                        controller_input->down.ended_down = down;
+                        controller_input->left.ended_down = left;
+                        controller_input->right.ended_down = right;
                     }
                     else
                     {
@@ -268,13 +299,20 @@ int main(int argc, char *argv[])
                 buffer.pitch = global_window_buffer.pitch;
                 buffer.bytes_per_pixel = global_window_buffer.bytes_per_pixel;
                 
-                GameUpdateAndRender(&input, &buffer);
+                GameUpdateAndRender(&memory, &input, &buffer);
+                if(capturing)
+                {
+                    CaptureFrame(&capture, &buffer);
+                }
                 MacOsRenderToScreen(renderer, &global_window_buffer);
 
-                // TODO: Should I be clearing the memory buffer in each frame?? 
-                
-                x_offset++;
+                if(saving && ((SDL_GetPerformanceCounter() - last_save_counter) >= AUTOSAVE_SECONDS * counter_frequency))
+                {
+                    SaveWriterSubmit(&saver, &memory);
+                    last_save_counter = SDL_GetPerformanceCounter();
+                }
 
+                // TODO: Should I be clearing the memory buffer in each frame?? 
 
                 u64 end_counter = mach_absolute_time();
                 u64 counter_elapsed = end_counter - last_counter;
@@ -289,6 +327,17 @@ int main(int argc, char *argv[])
                 last_counter = end_counter;
 
             }
+
+            if(capturing)
+            {
+                CaptureEnd(&capture);
+            }
+
+            if(saving)
+            {
+                SaveWriterFlush(&saver, &memory);
+                SaveWriterEnd(&saver);
+            }
         }
         else
         {
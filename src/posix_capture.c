@@ -0,0 +1,367 @@
+/* ============================================================================
+    $File: $
+    $Date: 2026-10-19
+    $Revision: $
+    $Creator: Pedro Gutierrez
+   ========================================================================= */
+
+// NOTE: Dumps every Nth game frame to disk for offline diffing. The game loop
+// only copies the frame into a free slot of a preallocated ring and signals
+// the writer thread, which does the delta encoding and file IO. If the ring is
+// full the frame is dropped instead of waiting on the disk, unless the capture
+// was started with wait_when_full (headless runs, where every frame matters
+// more than the frame time).
+
+#include <pthread.h>
+#include <string.h>
+
+#include "capture_format.h"
+
+#define CAPTURE_RING_SIZE 4
+
+// NOTE: A repeat token costs two words, shorter runs go out as literals.
+#define CAPTURE_MIN_REPEAT 3
+
+typedef struct
+{
+    u32 frame_index;
+    int width;
+    int height;
+    u32 *pixels;
+} capture_slot;
+
+typedef struct
+{
+    FILE *file;
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t slot_ready;
+    pthread_cond_t slot_free;
+
+    // NOTE: Guarded by the mutex.
+    capture_slot slots[CAPTURE_RING_SIZE];
+    u32 read_index;
+    u32 slot_count;
+    bool stopping;
+
+    // NOTE: Only touched by the game loop.
+    bool wait_when_full;
+    int every_n_frames;
+    u32 frame_index;
+    u32 dropped_frames;
+    int max_width;
+    int max_height;
+
+    // NOTE: Only touched by the writer thread. Once a write fails nothing more
+    // is written, the file would be corrupt from that point on anyway.
+    u32 *previous;
+    u32 *row_delta;
+    int previous_width;
+    int previous_height;
+    bool write_failed;
+} frame_capture;
+
+internal void CaptureWrite(frame_capture *capture, void *data, size_t size, size_t count)
+{
+    if(!capture->write_failed && (fwrite(data, size, count, capture->file) != count))
+    {
+        capture->write_failed = true;
+    }
+}
+
+internal bool CaptureRowsEqual(u32 *a, u32 *b, int width)
+{
+    return (memcmp(a, b, width * sizeof(u32)) == 0);
+}
+
+// NOTE: Per byte a - b, modulo 256.
+internal u32 CaptureByteDelta(u32 a, u32 b)
+{
+    return ((a | 0x80808080) - (b & 0x7F7F7F7F)) ^ ((a ^ ~b) & 0x80808080);
+}
+
+internal void CaptureWriteLiteral(frame_capture *capture, u32 *delta, int count)
+{
+    if(count > 0)
+    {
+        u32 token = (u32)count;
+        CaptureWrite(capture, &token, sizeof(u32), 1);
+        CaptureWrite(capture, delta, sizeof(u32), count);
+    }
+}
+
+internal void CaptureWriteRow(frame_capture *capture, u32 *delta, int width)
+{
+    int literal_start = 0;
+    int x = 0;
+    while(x < width)
+    {
+        int run = 1;
+        while((x + run < width) && (delta[x + run] == delta[x]))
+        {
+            run++;
+        }
+
+        if(run >= CAPTURE_MIN_REPEAT)
+        {
+            CaptureWriteLiteral(capture, delta + literal_start, x - literal_start);
+
+            u32 token[2] = { (u32)run | CAPTURE_TOKEN_REPEAT, delta[x] };
+            CaptureWrite(capture, token, sizeof(u32), 2);
+            literal_start = x + run;
+        }
+        x += run;
+    }
+    CaptureWriteLiteral(capture, delta + literal_start, width - literal_start);
+}
+
+internal void CaptureWriteFrame(frame_capture *capture, capture_slot *slot)
+{
+    int width = slot->width;
+    int height = slot->height;
+
+    if((width != capture->previous_width) || (height != capture->previous_height))
+    {
+        memset(capture->previous, 0, (size_t)width * height * sizeof(u32));
+        capture->previous_width = width;
+        capture->previous_height = height;
+    }
+
+    capture_frame_header header = {0};
+    header.magic = CAPTURE_FRAME_MAGIC;
+    header.frame_index = slot->frame_index;
+    header.width = width;
+    header.height = height;
+    CaptureWrite(capture, &header, sizeof(header), 1);
+
+    int y = 0;
+    while(y < height)
+    {
+        int unchanged_rows = 0;
+        while((y + unchanged_rows < height) &&
+              CaptureRowsEqual(slot->pixels + (y + unchanged_rows) * width,
+                               capture->previous + (y + unchanged_rows) * width, width))
+        {
+            unchanged_rows++;
+        }
+        y += unchanged_rows;
+
+        int changed_rows = 0;
+        while((y + changed_rows < height) &&
+              !CaptureRowsEqual(slot->pixels + (y + changed_rows) * width,
+                                capture->previous + (y + changed_rows) * width, width))
+        {
+            changed_rows++;
+        }
+
+        u32 runs[2] = { (u32)unchanged_rows, (u32)changed_rows };
+        CaptureWrite(capture, runs, sizeof(u32), 2);
+
+        for(int row = 0; row < changed_rows; row++, y++)
+        {
+            u32 *current = slot->pixels + y * width;
+            u32 *last = capture->previous + y * width;
+            for(int x = 0; x < width; x++)
+            {
+                capture->row_delta[x] = CaptureByteDelta(current[x], last[x]);
+            }
+            CaptureWriteRow(capture, capture->row_delta, width);
+            memcpy(last, current, width * sizeof(u32));
+        }
+    }
+}
+
+internal void *CaptureWriterThread(void *data)
+{
+    frame_capture *capture = (frame_capture*)data;
+
+    for(;;)
+    {
+        pthread_mutex_lock(&capture->mutex);
+        while((capture->slot_count == 0) && !capture->stopping)
+        {
+            pthread_cond_wait(&capture->slot_ready, &capture->mutex);
+        }
+        if(capture->slot_count == 0)
+        {
+            pthread_mutex_unlock(&capture->mutex);
+            break;
+        }
+        capture_slot *slot = &capture->slots[capture->read_index];
+        pthread_mutex_unlock(&capture->mutex);
+
+        if(!capture->write_failed)
+        {
+            CaptureWriteFrame(capture, slot);
+        }
+
+        pthread_mutex_lock(&capture->mutex);
+        capture->read_index = (capture->read_index + 1) % CAPTURE_RING_SIZE;
+        capture->slot_count--;
+        pthread_cond_signal(&capture->slot_free);
+        pthread_mutex_unlock(&capture->mutex);
+    }
+
+    return NULL;
+}
+
+internal void CaptureFreeBuffers(frame_capture *capture)
+{
+    for(int index = 0; index < CAPTURE_RING_SIZE; index++)
+    {
+        free(capture->slots[index].pixels);
+        capture->slots[index].pixels = NULL;
+    }
+    free(capture->previous);
+    capture->previous = NULL;
+    free(capture->row_delta);
+    capture->row_delta = NULL;
+}
+
+// NOTE: Frames bigger than max_width x max_height are not captured. With
+// wait_when_full the game loop blocks on a full ring instead of dropping.
+internal bool CaptureBegin(frame_capture *capture, char *path, int every_n_frames,
+                           int max_width, int max_height, bool wait_when_full)
+{
+    memset(capture, 0, sizeof(*capture));
+
+    if((max_width <= 0) || (max_height <= 0) ||
+       (max_width > CAPTURE_MAX_DIMENSION) || (max_height > CAPTURE_MAX_DIMENSION))
+    {
+        fprintf(stderr, "Error: Capture size %dx%d is not supported.\n", max_width, max_height);
+        return false;
+    }
+
+    capture->file = fopen(path, "wb");
+    if(!capture->file)
+    {
+        fprintf(stderr, "Error: Could not open capture file %s.\n", path);
+        return false;
+    }
+
+    size_t frame_size = (size_t)max_width * max_height * sizeof(u32);
+    bool allocated = true;
+    for(int index = 0; index < CAPTURE_RING_SIZE; index++)
+    {
+        capture->slots[index].pixels = (u32*)malloc(frame_size);
+        allocated = (allocated && capture->slots[index].pixels);
+    }
+    capture->previous = (u32*)malloc(frame_size);
+    capture->row_delta = (u32*)malloc((size_t)max_width * sizeof(u32));
+    allocated = (allocated && capture->previous && capture->row_delta);
+
+    if(!allocated)
+    {
+        fprintf(stderr, "Error: Could not allocate capture buffers.\n");
+        CaptureFreeBuffers(capture);
+        fclose(capture->file);
+        return false;
+    }
+
+    capture->wait_when_full = wait_when_full;
+    capture->every_n_frames = (every_n_frames > 0) ? every_n_frames : 1;
+    capture->max_width = max_width;
+    capture->max_height = max_height;
+
+    capture_file_header header = {0};
+    header.magic = CAPTURE_FILE_MAGIC;
+    header.version = CAPTURE_VERSION;
+    CaptureWrite(capture, &header, sizeof(header), 1);
+
+    pthread_mutex_init(&capture->mutex, NULL);
+    pthread_cond_init(&capture->slot_ready, NULL);
+    pthread_cond_init(&capture->slot_free, NULL);
+    if(pthread_create(&capture->thread, NULL, CaptureWriterThread, capture) != 0)
+    {
+        fprintf(stderr, "Error: Could not start capture writer thread.\n");
+        pthread_cond_destroy(&capture->slot_free);
+        pthread_cond_destroy(&capture->slot_ready);
+        pthread_mutex_destroy(&capture->mutex);
+        CaptureFreeBuffers(capture);
+        fclose(capture->file);
+        return false;
+    }
+
+    return true;
+}
+
+// NOTE: Called once per frame from the game loop, after the game has drawn.
+internal void CaptureFrame(frame_capture *capture, gamescreen_buffer *buffer)
+{
+    u32 frame_index = capture->frame_index++;
+    if((frame_index % capture->every_n_frames) != 0)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&capture->mutex);
+    while(capture->wait_when_full && (capture->slot_count == CAPTURE_RING_SIZE))
+    {
+        pthread_cond_wait(&capture->slot_free, &capture->mutex);
+    }
+    bool has_free_slot = (capture->slot_count < CAPTURE_RING_SIZE);
+    u32 write_index = (capture->read_index + capture->slot_count) % CAPTURE_RING_SIZE;
+    pthread_mutex_unlock(&capture->mutex);
+
+    if(!has_free_slot || (buffer->width > capture->max_width) || (buffer->height > capture->max_height))
+    {
+        capture->dropped_frames++;
+        return;
+    }
+
+    // NOTE: The writer never touches slots past read_index + slot_count, so
+    // this one can be filled without holding the lock.
+    capture_slot *slot = &capture->slots[write_index];
+    slot->frame_index = frame_index;
+    slot->width = buffer->width;
+    slot->height = buffer->height;
+
+    u8 *row = (u8*)buffer->memory;
+    for(int y = 0; y < buffer->height; y++)
+    {
+        memcpy(slot->pixels + y * buffer->width, row, buffer->width * sizeof(u32));
+        row += buffer->pitch;
+    }
+
+    pthread_mutex_lock(&capture->mutex);
+    capture->slot_count++;
+    pthread_cond_signal(&capture->slot_ready);
+    pthread_mutex_unlock(&capture->mutex);
+}
+
+// NOTE: Drains whatever is still queued, then closes the file. Returns false
+// if the file on disk is incomplete.
+internal bool CaptureEnd(frame_capture *capture)
+{
+    pthread_mutex_lock(&capture->mutex);
+    capture->stopping = true;
+    pthread_cond_signal(&capture->slot_ready);
+    pthread_mutex_unlock(&capture->mutex);
+    pthread_join(capture->thread, NULL);
+
+    if((fflush(capture->file) != 0) || ferror(capture->file))
+    {
+        capture->write_failed = true;
+    }
+    if(fclose(capture->file) != 0)
+    {
+        capture->write_failed = true;
+    }
+    capture->file = NULL;
+    CaptureFreeBuffers(capture);
+
+    pthread_cond_destroy(&capture->slot_free);
+    pthread_cond_destroy(&capture->slot_ready);
+    pthread_mutex_destroy(&capture->mutex);
+
+    if(capture->dropped_frames)
+    {
+        fprintf(stderr, "Capture: dropped %u frames.\n", capture->dropped_frames);
+    }
+    if(capture->write_failed)
+    {
+        fprintf(stderr, "Capture: a write failed, the capture file is incomplete.\n");
+    }
+
+    return !capture->write_failed;
+}
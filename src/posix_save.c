@@ -0,0 +1,280 @@
+/* ============================================================================
+    $File: $
+    $Date: 2026-10-19
+    $Revision: $
+    $Creator: Pedro Gutierrez
+   ========================================================================= */
+
+// NOTE: Autosave. The game loop only serializes the state into a staging
+// buffer and signals; the writer thread does write + fsync into a temp file
+// and renames it over the save, so a crash mid-write never leaves a torn file.
+// If the previous save is still being written an autosave is skipped; the
+// save on exit goes through SaveWriterFlush, which waits for it instead.
+
+#include <pthread.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define SAVE_STAGING_SIZE (1024 * 1024)
+
+typedef struct
+{
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t save_ready;
+    pthread_cond_t save_done;
+
+    // NOTE: Guarded by the mutex. While busy the staging buffer belongs to
+    // the writer thread.
+    bool busy;
+    bool stopping;
+    size_t staging_used;
+
+    u8 *staging;
+    size_t staging_size;
+    u32 skipped_saves;
+    u32 failed_saves;
+
+    char path[1024];
+    char temp_path[1024];
+} save_writer;
+
+internal bool SaveWriteAll(int file, u8 *data, size_t size)
+{
+    while(size > 0)
+    {
+        ssize_t written = write(file, data, size);
+        if(written < 0)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        size -= (size_t)written;
+    }
+    return true;
+}
+
+internal bool SaveWriteFile(save_writer *writer)
+{
+    int file = open(writer->temp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(file < 0)
+    {
+        return false;
+    }
+
+    bool result = (SaveWriteAll(file, writer->staging, writer->staging_used) &&
+                   (fsync(file) == 0));
+    result = ((close(file) == 0) && result);
+    result = (result && (rename(writer->temp_path, writer->path) == 0));
+
+    if(!result)
+    {
+        // NOTE: Don't leave a partial temp file next to the save.
+        unlink(writer->temp_path);
+    }
+    else
+    {
+        // NOTE: Make the rename itself durable.
+        char directory[1024];
+        strcpy(directory, writer->path);
+        char *slash = strrchr(directory, '/');
+        if(slash)
+        {
+            *(slash == directory ? slash + 1 : slash) = 0;
+        }
+        else
+        {
+            strcpy(directory, ".");
+        }
+
+        int directory_file = open(directory, O_RDONLY);
+        if(directory_file >= 0)
+        {
+            fsync(directory_file);
+            close(directory_file);
+        }
+    }
+
+    return result;
+}
+
+internal void *SaveWriterThread(void *data)
+{
+    save_writer *writer = (save_writer*)data;
+
+    pthread_mutex_lock(&writer->mutex);
+    for(;;)
+    {
+        while(!writer->busy && !writer->stopping)
+        {
+            pthread_cond_wait(&writer->save_ready, &writer->mutex);
+        }
+        if(!writer->busy)
+        {
+            break;
+        }
+        pthread_mutex_unlock(&writer->mutex);
+
+        bool written = SaveWriteFile(writer);
+
+        pthread_mutex_lock(&writer->mutex);
+        if(!written)
+        {
+            writer->failed_saves++;
+        }
+        writer->busy = false;
+        pthread_cond_broadcast(&writer->save_done);
+    }
+    pthread_mutex_unlock(&writer->mutex);
+
+    return NULL;
+}
+
+internal bool SaveWriterBegin(save_writer *writer, char *path, size_t staging_size)
+{
+    memset(writer, 0, sizeof(*writer));
+
+    if(snprintf(writer->path, sizeof(writer->path), "%s", path) >= (int)sizeof(writer->path) ||
+       snprintf(writer->temp_path, sizeof(writer->temp_path), "%s.tmp", path) >= (int)sizeof(writer->temp_path))
+    {
+        fprintf(stderr, "Error: Save path %s is too long.\n", path);
+        return false;
+    }
+
+    writer->staging = (u8*)malloc(staging_size);
+    writer->staging_size = staging_size;
+    if(!writer->staging)
+    {
+        fprintf(stderr, "Error: Could not allocate save staging buffer.\n");
+        return false;
+    }
+
+    // NOTE: Touch the pages now so the first autosave doesn't fault them in.
+    memset(writer->staging, 0, staging_size);
+
+    pthread_mutex_init(&writer->mutex, NULL);
+    pthread_cond_init(&writer->save_ready, NULL);
+    pthread_cond_init(&writer->save_done, NULL);
+    if(pthread_create(&writer->thread, NULL, SaveWriterThread, writer) != 0)
+    {
+        fprintf(stderr, "Error: Could not start save writer thread.\n");
+        pthread_cond_destroy(&writer->save_done);
+        pthread_cond_destroy(&writer->save_ready);
+        pthread_mutex_destroy(&writer->mutex);
+        free(writer->staging);
+        return false;
+    }
+
+    return true;
+}
+
+// NOTE: The writer thread must be idle, the staging buffer is ours until
+// busy is set again.
+internal bool SaveWriterStage(save_writer *writer, game_memory *memory)
+{
+    size_t used = GameSaveState(memory, writer->staging, writer->staging_size);
+    if(used == 0)
+    {
+        fprintf(stderr, "Error: Game state does not fit the save staging buffer.\n");
+        return false;
+    }
+
+    pthread_mutex_lock(&writer->mutex);
+    writer->staging_used = used;
+    writer->busy = true;
+    pthread_cond_signal(&writer->save_ready);
+    pthread_mutex_unlock(&writer->mutex);
+
+    return true;
+}
+
+// NOTE: Called from the game loop. Never waits on the disk, returns false if
+// the save was skipped.
+internal bool SaveWriterSubmit(save_writer *writer, game_memory *memory)
+{
+    pthread_mutex_lock(&writer->mutex);
+    bool busy = writer->busy;
+    pthread_mutex_unlock(&writer->mutex);
+
+    if(busy)
+    {
+        writer->skipped_saves++;
+        return false;
+    }
+
+    return SaveWriterStage(writer, memory);
+}
+
+// NOTE: For the save on exit. Waits for a save in flight to finish so this
+// snapshot, the newest one, is never the one dropped.
+internal bool SaveWriterFlush(save_writer *writer, game_memory *memory)
+{
+    pthread_mutex_lock(&writer->mutex);
+    while(writer->busy)
+    {
+        pthread_cond_wait(&writer->save_done, &writer->mutex);
+    }
+    pthread_mutex_unlock(&writer->mutex);
+
+    return SaveWriterStage(writer, memory);
+}
+
+// NOTE: Finishes the save in flight, if any, and stops the thread.
+internal void SaveWriterEnd(save_writer *writer)
+{
+    pthread_mutex_lock(&writer->mutex);
+    writer->stopping = true;
+    pthread_cond_signal(&writer->save_ready);
+    pthread_mutex_unlock(&writer->mutex);
+    pthread_join(writer->thread, NULL);
+
+    pthread_cond_destroy(&writer->save_done);
+    pthread_cond_destroy(&writer->save_ready);
+    pthread_mutex_destroy(&writer->mutex);
+    free(writer->staging);
+
+    if(writer->skipped_saves || writer->failed_saves)
+    {
+        fprintf(stderr, "Save: skipped %u, failed %u.\n", writer->skipped_saves, writer->failed_saves);
+    }
+}
+
+// NOTE: The snapshot is read straight out of the mapping, no copy of the
+// file is made. Returns false if there is no save or it is bad.
+internal bool LoadGameFile(char *path, game_memory *memory)
+{
+    int file = open(path, O_RDONLY);
+    if(file < 0)
+    {
+        return false;
+    }
+
+    bool result = false;
+    struct stat file_stat;
+    if((fstat(file, &file_stat) == 0) && (file_stat.st_size > 0))
+    {
+        size_t size = (size_t)file_stat.st_size;
+        void *mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, file, 0);
+        if(mapping != MAP_FAILED)
+        {
+            posix_madvise(mapping, size, POSIX_MADV_SEQUENTIAL);
+            result = GameLoadState(memory, mapping, size);
+            munmap(mapping, size);
+        }
+    }
+    close(file);
+
+    if(!result)
+    {
+        fprintf(stderr, "Error: Could not load save %s.\n", path);
+    }
+    return result;
+}